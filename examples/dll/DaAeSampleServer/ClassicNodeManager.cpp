@@ -449,21 +449,20 @@ unsigned __stdcall RefreshThread( LPVOID pAttr )
 			ProcessSimpleEvent( CATID_DEVFAILURE, SRCID_NETADAPT, L"No response", 800, 2, devfailattrs, &TimeStamp );
 		}
 
-		// update server cache for this item
-		V_I4( &Value ) = gDataSimulation.RampValue();
-		V_VT( &Value ) = VT_I4;                 
+		// update server cache for the simulated items with one call
+		void*       simHandles[3]    = { gDeviceItem_SimRamp, gDeviceItem_SimSine, gDeviceItem_SimRandom };
+		VARIANT     simValues[3];
+		short       simQualities[3]  = { (OPC_QUALITY_GOOD | OPC_LIMIT_OK), (OPC_QUALITY_GOOD | OPC_LIMIT_OK), (OPC_QUALITY_GOOD | OPC_LIMIT_OK) };
+		FILETIME    simTimeStamps[3] = { TimeStamp, TimeStamp, TimeStamp };
 
-			SetItemValue(gDeviceItem_SimRamp, &Value, (OPC_QUALITY_GOOD | OPC_LIMIT_OK), TimeStamp);
+		V_I4( &simValues[0] ) = gDataSimulation.RampValue();
+		V_VT( &simValues[0] ) = VT_I4;
+		V_R8( &simValues[1] ) = gDataSimulation.SineValue();
+		V_VT( &simValues[1] ) = VT_R8;
+		V_I4( &simValues[2] ) = gDataSimulation.RandomValue();
+		V_VT( &simValues[2] ) = VT_I4;
 
-		V_R8( &Value ) = gDataSimulation.SineValue();
-		V_VT( &Value ) = VT_R8;                 
-
-			SetItemValue(gDeviceItem_SimSine, &Value, (OPC_QUALITY_GOOD | OPC_LIMIT_OK), TimeStamp);
-
-		V_I4( &Value ) = gDataSimulation.RandomValue();
-		V_VT( &Value ) = VT_I4;                 
-
-			SetItemValue(gDeviceItem_SimRandom, &Value, (OPC_QUALITY_GOOD | OPC_LIMIT_OK), TimeStamp);
+			SetItemValues(3, simHandles, simValues, simQualities, simTimeStamps, nullptr);
 
 		}
 
@@ -1420,6 +1419,7 @@ DLLEXP void DLLCALL OnStartupSignal(char* commandLine)
 DLLEXP void DLLCALL OnShutdownSignal()
 {
 	KillThreads();
+	StopItemNotifications();
 }
 
 
@@ -1906,6 +1906,63 @@ DLLEXP HRESULT DLLCALL OnRemoveItem(
 }
 
 
+/// <summary>
+/// The items listed in the deviceItems array were added to a group
+/// or get used for item based read/write.
+/// 
+/// This method is only called if OnAddItem forwards the
+/// notification with QueueAddItem. It is called from a background
+/// thread and not from the generic server.
+/// </summary>
+/// <returns>
+/// A result code with the result of the operation.
+/// </returns>
+/// <param name="count">Number of device items</param>
+/// <param name="deviceItems">Array with the device items that
+///                           need to be updated.</param>
+DLLEXP HRESULT DLLCALL OnAddItems(
+	/* in */       int		  count,
+	/* in */       void**	  deviceItems)
+{
+	return S_OK;
+}
+
+
+/// <summary>
+/// The items listed in the deviceItems array are no longer used
+/// by clients.
+/// 
+/// This method is only called if OnRemoveItem forwards the
+/// notification with QueueRemoveItem. It is called from a
+/// background thread and not from the generic server.
+/// </summary>
+/// <returns>
+/// A result code with the result of the operation.
+/// </returns>
+/// <param name="count">Number of device items</param>
+/// <param name="deviceItems">Array with the device items that no
+///                           longer need to be updated.</param>
+DLLEXP HRESULT DLLCALL OnRemoveItems(
+	/* in */       int		  count,
+	/* in */       void**	  deviceItems)
+{
+	return S_OK;
+}
+
+
+/// <summary>
+/// Batch window in milliseconds for the notifications queued with
+/// QueueAddItem and QueueRemoveItem.
+/// </summary>
+/// <returns>
+/// The batch window in milliseconds.
+/// </returns>
+DLLEXP int DLLCALL OnGetItemNotificationDelay()
+{
+	return 100;
+}
+
+
 /// <summary>
 /// This method is called when a client executes a 'write' server
 /// call. The items specified in the OPCITEMVQT array need to be
@@ -2024,7 +2081,8 @@ DLLEXP void DLLCALL OnGetLogPath(char * logPath)
 /// 
 ///   * add the items to the servers real address space and return
 ///     S_OK. For each item to be added the callback method 'AddItem'
-///     has to be called.
+///     has to be called. If many items are requested, add them with
+///     one call of 'AddItems' instead.
 ///   * return S_FALSE
 /// </summary>
 /// <returns>
@@ -35,6 +35,9 @@
 // INCLUDES
 //-----------------------------------------------------------------------------
 #include "stdafx.h"
+#include <process.h>
+#include <map>
+#include <vector>
 #include "IClassicBaseNodeManager.h"
 
 namespace IClassicBaseNodeManager
@@ -71,6 +74,16 @@ GetGroupsPtr                            getGroupsCallback;
 GetGroupStatePtr                        getGroupStateCallback;
 GetItemStatesPtr                        getItemStatesCallback;
 
+//-----------------------------------------------------------------------------
+// Deferred OnAddItem/OnRemoveItem notifications
+//-----------------------------------------------------------------------------
+// Pending notifications; +1 for each add and -1 for each remove
+static SRWLOCK							pendingItemsLock = SRWLOCK_INIT;
+static std::map<void*, int>				pendingItems;
+static HANDLE							pendingItemsEvent = NULL;
+static HANDLE							terminateItemNotificationEvent = NULL;
+static HANDLE							itemNotificationThread = NULL;
+
 
 //----------------------------------------------------------------------------
 // These structures, enumerations and classes match the OPC specifications 
@@ -92,8 +105,50 @@ HRESULT AddAnalogItem(LPWSTR itemID, DaAccessRights accessRights, LPVARIANT init
 	return addItemCallback(itemID, accessRights, initValue, true, Analog, minValue, maxValue, deviceItemHandle);
 }
 
+HRESULT AddItems(int count, LPWSTR* itemIds, DaAccessRights* accessRights, LPVARIANT initValues, DaEuType* euTypes, double* minValues, double* maxValues, void** deviceItemHandles, HRESULT* errors)
+{
+	if (count <= 0) {
+		return S_OK;
+	}
+	if (itemIds == nullptr || accessRights == nullptr || initValues == nullptr) {
+		return E_INVALIDARG;
+	}
+	if (euTypes != nullptr && (minValues == nullptr || maxValues == nullptr)) {
+		for (int i = 0; i < count; i++) {
+			if (euTypes[i] == Analog) {
+				return E_INVALIDARG;					// EU ranges required for analog items
+			}
+		}
+	}
+
+	HRESULT hrReturn = S_OK;
+	for (int i = 0; i < count; i++) {
+		DaEuType euType = euTypes ? euTypes[i] : NoEnum;
+		double   minValue = (euType == Analog) ? minValues[i] : 0.0;
+		double   maxValue = (euType == Analog) ? maxValues[i] : 0.0;
+		void*    deviceItem = nullptr;
+
+		HRESULT hr = addItemCallback(itemIds[i], accessRights[i], &initValues[i], true, euType, minValue, maxValue, &deviceItem);
+		if (deviceItemHandles != nullptr) {
+			deviceItemHandles[i] = SUCCEEDED(hr) ? deviceItem : nullptr;
+		}
+		if (errors != nullptr) {
+			errors[i] = hr;
+		}
+		if (FAILED(hr)) {
+			hrReturn = S_FALSE;
+		}
+	}
+	return hrReturn;
+}
+
 HRESULT RemoveItem(void* deviceItemHandle)
 {
+	// the handle becomes invalid, don't pass it to OnAddItems/OnRemoveItems later
+	AcquireSRWLockExclusive(&pendingItemsLock);
+	pendingItems.erase(deviceItemHandle);
+	ReleaseSRWLockExclusive(&pendingItemsLock);
+
 	return removeItemCallback(deviceItemHandle);
 }
 
@@ -107,6 +162,143 @@ HRESULT SetItemValue(void* deviceItemHandle, LPVARIANT newValue, short quality,
 	return setItemValueCallback(deviceItemHandle, newValue, quality, timestamp);
 }
 
+HRESULT SetItemValues(int count, void** deviceItemHandles, LPVARIANT newValues, short* qualities, FILETIME* timestamps, HRESULT* errors)
+{
+	if (count <= 0) {
+		return S_OK;
+	}
+	if (deviceItemHandles == nullptr || qualities == nullptr || timestamps == nullptr) {
+		return E_INVALIDARG;
+	}
+
+	HRESULT hrReturn = S_OK;
+	for (int i = 0; i < count; i++) {
+		HRESULT hr = setItemValueCallback(deviceItemHandles[i], newValues ? &newValues[i] : nullptr, qualities[i], timestamps[i]);
+		if (errors != nullptr) {
+			errors[i] = hr;
+		}
+		if (FAILED(hr)) {
+			hrReturn = S_FALSE;
+		}
+	}
+	return hrReturn;
+}
+
+// Delivers the collected OnAddItem/OnRemoveItem notifications as batches.
+static unsigned __stdcall ItemNotificationThread( LPVOID batchWindow )
+{
+	DWORD  delay = (DWORD)(INT_PTR)batchWindow;
+	HANDLE events[2] = { terminateItemNotificationEvent, pendingItemsEvent };
+	std::vector<void*> added;
+	std::vector<void*> removed;
+
+	for (;;) {
+		if (WaitForMultipleObjects(2, events, FALSE, INFINITE) != WAIT_OBJECT_0 + 1) {
+			break;										// Terminate Thread
+		}
+		// collect further notifications of this batch
+		if (WaitForSingleObject(terminateItemNotificationEvent, delay) != WAIT_TIMEOUT) {
+			break;										// Terminate Thread
+		}
+
+		std::map<void*, int> items;
+		AcquireSRWLockExclusive(&pendingItemsLock);
+		items.swap(pendingItems);
+		ReleaseSRWLockExclusive(&pendingItemsLock);
+
+		added.clear();
+		removed.clear();
+		for (std::map<void*, int>::const_iterator it = items.begin(); it != items.end(); ++it) {
+			if (it->second > 0) {
+				added.push_back(it->first);
+			}
+			else {
+				removed.push_back(it->first);
+			}
+		}
+
+		// the results are not evaluated; a failed batch does not prevent the other one
+		if (!removed.empty()) {
+			OnRemoveItems((int)removed.size(), removed.data());
+		}
+		if (!added.empty()) {
+			OnAddItems((int)added.size(), added.data());
+		}
+	}
+
+	_endthreadex( 0 );
+	return 0;
+}
+
+static HRESULT QueueItemNotification(void* deviceItemHandle, int delta)
+{
+	bool startThread = false;
+
+	AcquireSRWLockExclusive(&pendingItemsLock);
+	int count = pendingItems[deviceItemHandle] + delta;
+	if (count == 0) {
+		pendingItems.erase(deviceItemHandle);			// add/remove pair, nothing to report
+	}
+	else {
+		pendingItems[deviceItemHandle] = count;
+	}
+	if (pendingItemsEvent == NULL) {
+		pendingItemsEvent = CreateEvent(NULL, FALSE, FALSE, NULL);
+		terminateItemNotificationEvent = CreateEvent(NULL, TRUE, FALSE, NULL);
+		startThread = true;
+	}
+	ReleaseSRWLockExclusive(&pendingItemsLock);
+
+	if (pendingItemsEvent == NULL || terminateItemNotificationEvent == NULL) {
+		return E_FAIL;
+	}
+	SetEvent(pendingItemsEvent);
+	if (startThread) {
+		// don't call into the customization plugin while holding the lock
+		int delay = OnGetItemNotificationDelay();
+		unsigned threadId;
+		itemNotificationThread = (HANDLE)_beginthreadex(NULL, 0, ItemNotificationThread, (LPVOID)(INT_PTR)delay, 0, &threadId);
+		if (itemNotificationThread == 0) {
+			return E_FAIL;
+		}
+	}
+	return S_OK;
+}
+
+HRESULT QueueAddItem(void* deviceItemHandle)
+{
+	return QueueItemNotification(deviceItemHandle, 1);
+}
+
+HRESULT QueueRemoveItem(void* deviceItemHandle)
+{
+	return QueueItemNotification(deviceItemHandle, -1);
+}
+
+void StopItemNotifications()
+{
+	if (itemNotificationThread != NULL) {
+		SetEvent(terminateItemNotificationEvent);
+		if (WaitForSingleObject(itemNotificationThread, 10000) == WAIT_TIMEOUT) {
+			TerminateThread(itemNotificationThread, 1);
+		}
+		CloseHandle(itemNotificationThread);
+		itemNotificationThread = NULL;
+	}
+
+	AcquireSRWLockExclusive(&pendingItemsLock);
+	pendingItems.clear();
+	if (pendingItemsEvent != NULL) {
+		CloseHandle(pendingItemsEvent);
+		pendingItemsEvent = NULL;
+	}
+	if (terminateItemNotificationEvent != NULL) {
+		CloseHandle(terminateItemNotificationEvent);
+		terminateItemNotificationEvent = NULL;
+	}
+	ReleaseSRWLockExclusive(&pendingItemsLock);
+}
+
 void SetServerState( ServerState serverState )
 {
     setServerStateCallback(serverState);
@@ -271,6 +463,52 @@ HRESULT ProcessTrackingEvent( int categoryId, int sourceId, LPWSTR message, int
 	return processTrackingEventCallback( categoryId, sourceId, message, severity, actorId, attributeCount, attributeValues, timeStamp );
 }
 
+HRESULT ProcessSimpleEvents( int count, AeEventRecord* events, HRESULT* errors )
+{
+	if (count <= 0) {
+		return S_OK;
+	}
+	if (events == nullptr) {
+		return E_INVALIDARG;
+	}
+
+	HRESULT hrReturn = S_OK;
+	for (int i = 0; i < count; i++) {
+		AeEventRecord& e = events[i];
+		HRESULT hr = processSimpleEventCallback( e.CategoryId, e.SourceId, e.Message, e.Severity, e.AttributeCount, e.AttributeValues, e.TimeStamp );
+		if (errors != nullptr) {
+			errors[i] = hr;
+		}
+		if (FAILED(hr)) {
+			hrReturn = S_FALSE;
+		}
+	}
+	return hrReturn;
+}
+
+HRESULT ProcessTrackingEvents( int count, AeEventRecord* events, HRESULT* errors )
+{
+	if (count <= 0) {
+		return S_OK;
+	}
+	if (events == nullptr) {
+		return E_INVALIDARG;
+	}
+
+	HRESULT hrReturn = S_OK;
+	for (int i = 0; i < count; i++) {
+		AeEventRecord& e = events[i];
+		HRESULT hr = processTrackingEventCallback( e.CategoryId, e.SourceId, e.Message, e.Severity, e.ActorId, e.AttributeCount, e.AttributeValues, e.TimeStamp );
+		if (errors != nullptr) {
+			errors[i] = hr;
+		}
+		if (FAILED(hr)) {
+			hrReturn = S_FALSE;
+		}
+	}
+	return hrReturn;
+}
+
 HRESULT ProcessConditionStateChanges(int count, AeConditionState* AeConditionStateChanges)
 {
     return processConditionStateChangesCallback(count, AeConditionStateChanges);
@@ -451,6 +451,66 @@ protected:
 
 };
 
+/**
+ * @class   AeEventRecord
+ *
+ * @brief   A Simple or Tracking Event passed to ProcessSimpleEvents() or ProcessTrackingEvents().
+ */
+
+class AeEventRecord
+{
+    // Attributes
+public:
+    /**
+    * @brief   Identifier of an existing Event Category.
+    */
+
+    int         CategoryId;
+
+    /**
+    * @brief   Identifier of an existing Event Source.
+    */
+
+    int         SourceId;
+
+    /**
+    * @brief   Message text string which describes the Event.
+    */
+
+    LPWSTR      Message;
+
+    /**
+    * @brief   The urgency of the Event in the range of 1 ... 1000.
+    */
+
+    int         Severity;
+
+    /**
+    * @brief   Text string which identifies the OPC Client which initiated the action. Only used
+    *          for Tracking Events.
+    */
+
+    LPWSTR      ActorId;
+
+    /**
+    * @brief   Number of attribute values specified in AttributeValues.
+    */
+
+    int         AttributeCount;
+
+    /**
+    * @brief   Array of attribute values.
+    */
+
+    LPVARIANT   AttributeValues;
+
+    /**
+    * @brief   Occurrence time of the event. If NULL the current time is used.
+    */
+
+    LPFILETIME  TimeStamp;
+};
+
 class DaGroupState
 {
     // Attributes
@@ -675,6 +735,44 @@ HRESULT AddItem(LPWSTR itemId, DaAccessRights accessRights, LPVARIANT initValue,
 
 HRESULT AddAnalogItem(LPWSTR itemId, DaAccessRights accessRights, LPVARIANT initValue, double minValue, double maxValue, void** deviceItemHandle = nullptr);
 
+/**
+ * @fn  HRESULT AddItems(int count, LPWSTR* itemIds, DaAccessRights* accessRights, LPVARIANT initValues, DaEuType* euTypes, double* minValues, double* maxValues, void** deviceItemHandles, HRESULT* errors);
+ *
+ * @brief   This function is called by the customization plugin and adds several items to the
+ *          generic server cache with one call. It is intended for plugins which define a large
+ *          number of items in <see cref="OnCreateServerItems" text="OnCreateServerItems" />.
+ *
+ *          The items are added in the order of the itemIds array.
+ *
+ * @param           count               Number of items to add.
+ * @param [in]      itemIds             Array with count fully qualified item names.
+ * @param [in]      accessRights        Array with count access rights.
+ * @param [in]      initValues          Array with count initial values. The values define the
+ *                                      canonical data type of the items.
+ * @param [in]      euTypes             Array with count EU types. Can be null, in this case
+ *                                      <see cref="DaEuType::NoEnum" text="DaEuType.NoEnum" />
+ *                                      is used for all items.
+ * @param [in]      minValues           Array with count LOW EU ranges. Only used for items with
+ *                                      <see cref="DaEuType::Analog" text="DaEuType.Analog" />;
+ *                                      required if at least one entry of euTypes is Analog,
+ *                                      otherwise it can be null.
+ * @param [in]      maxValues           Array with count HIGH EU ranges. Only used for items with
+ *                                      <see cref="DaEuType::Analog" text="DaEuType.Analog" />;
+ *                                      required if at least one entry of euTypes is Analog,
+ *                                      otherwise it can be null.
+ * @param [out]     deviceItemHandles   Array with count elements receiving the created device
+ *                                      items. Can be null if the handles are not required.
+ * @param [out]     errors              Array with count elements receiving the result of the
+ *                                      operation for each item. Can be null if the per item
+ *                                      results are not required.
+ *
+ * @return  A HRESULT code with the result of the operation. Returns S_OK if all items were
+ *          successfully added to the cache, S_FALSE if at least one item could not be added
+ *          and E_INVALIDARG if one of the required arrays is null.
+ */
+
+HRESULT AddItems(int count, LPWSTR* itemIds, DaAccessRights* accessRights, LPVARIANT initValues, DaEuType* euTypes, double* minValues, double* maxValues, void** deviceItemHandles, HRESULT* errors);
+
 /**
  * @brief    This function is called by the customization plugin and removes an item from the
  *             generic server cache. If
@@ -711,6 +809,59 @@ HRESULT RemoveItem(void* deviceItemHandle);
 
 HRESULT DeleteItem(void* deviceItemHandle);
 
+/**
+ * @fn  HRESULT QueueAddItem(void* deviceItemHandle);
+ *
+ * @brief   Defers an OnAddItem notification. Call this function from
+ *          <see cref="OnAddItem@void*" text="OnAddItem" /> to return immediately to the generic
+ *          server and receive the item later with
+ *          <see cref="OnAddItems@int@void**" text="OnAddItems" />.
+ *          
+ *          A background thread collects the notifications for the batch window returned by
+ *          <see cref="OnGetItemNotificationDelay" text="OnGetItemNotificationDelay" /> and
+ *          delivers them with one OnRemoveItems and one OnAddItems call. Items which were added
+ *          and removed again within the same batch window are not reported.
+ *          
+ *          Call <see cref="StopItemNotifications" text="StopItemNotifications" /> in
+ *          OnShutdownSignal if this function is used.
+ *
+ * @param [in]  deviceItemHandle    Device Item passed to OnAddItem.
+ *
+ * @return  A HRESULT code with the result of the operation. Returns E_FAIL if the background
+ *          thread could not be started.
+ */
+
+HRESULT QueueAddItem(void* deviceItemHandle);
+
+/**
+ * @fn  HRESULT QueueRemoveItem(void* deviceItemHandle);
+ *
+ * @brief   Defers an OnRemoveItem notification. Call this function from
+ *          <see cref="OnRemoveItem@void*" text="OnRemoveItem" /> to return immediately to the
+ *          generic server and receive the item later with
+ *          <see cref="OnRemoveItems@int@void**" text="OnRemoveItems" />.
+ *          
+ *          Items which were removed and added again within the same batch window are not
+ *          reported.
+ *
+ * @param [in]  deviceItemHandle    Device Item passed to OnRemoveItem.
+ *
+ * @return  A HRESULT code with the result of the operation. Returns E_FAIL if the background
+ *          thread could not be started.
+ */
+
+HRESULT QueueRemoveItem(void* deviceItemHandle);
+
+/**
+ * @fn  void StopItemNotifications();
+ *
+ * @brief   Terminates the background thread started by QueueAddItem or QueueRemoveItem and
+ *          discards all pending notifications. Must be called in OnShutdownSignal before the
+ *          plugin DLL is unloaded. Does nothing if no notification was queued.
+ */
+
+void StopItemNotifications();
+
 /**
  * @fn  HRESULT AddProperty(int propertyId, LPWSTR description, LPVARIANT valueType);
  *
@@ -751,6 +902,38 @@ HRESULT AddProperty(int propertyId, LPWSTR description, LPVARIANT valueType);
 
 HRESULT SetItemValue(void* deviceItemHandle, LPVARIANT newValue, short quality, FILETIME timestamp);
 
+/**
+ * @fn  HRESULT SetItemValues(int count, void** deviceItemHandles, LPVARIANT newValues, short* qualities, FILETIME* timestamps, HRESULT* errors);
+ *
+ * @brief   Generic server callback method.
+ *          
+ *            Write the values of several items into the cache with one call. Device drivers
+ *            updating many items per scan should use this function instead of calling
+ *            <see cref="SetItemValue@void*@LPVARIANT@short@FILETIME" text="SetItemValue" />()
+ *            for each item.
+ *
+ * @param           count               Number of items to update.
+ * @param [in]      deviceItemHandles   Array with count Device Items as defined in the AddItem
+ *                                      method call.
+ * @param [in]      newValues           Array with count new item values. Each value must match
+ *                                      the canonical data type of the corresponding item. null
+ *                                      can be passed to change only the quality and timestamp
+ *                                      of all items.
+ * @param [in]      qualities           Array with count new qualities.
+ * @param [in]      timestamps          Array with count new timestamps.
+ * @param [out]     errors              Array with count elements receiving the result of the
+ *                                      operation for each item. Can be null if the per item
+ *                                      results are not required.
+ *
+ * @return  A HRESULT code with the result of the operation.
+ *          
+ *           Returns S_OK if all values were successfully written into the cache, S_FALSE if
+ *           at least one value could not be written and E_INVALIDARG if one of the required
+ *           arrays is null.
+ */
+
+HRESULT SetItemValues(int count, void** deviceItemHandles, LPVARIANT newValues, short* qualities, FILETIME* timestamps, HRESULT* errors);
+
 /**
  * @fn  void SetServerState(ServerState serverState);
  *
@@ -1160,6 +1343,48 @@ HRESULT ProcessSimpleEvent(int categoryId, int sourceId, LPWSTR message, int sev
 
 HRESULT ProcessTrackingEvent(int categoryId, int sourceId, LPWSTR message, int severity, LPWSTR actorId, int attributeCount, LPVARIANT attributeValues, LPFILETIME timeStamp);
 
+/**
+ * @fn  HRESULT ProcessSimpleEvents(int count, AeEventRecord* events, HRESULT* errors);
+ *
+ * @brief   Generates several Simple Events with one call.
+ *          
+ *          The events are processed in the order of the events array. See
+ *          <see cref="ProcessSimpleEvent" text="ProcessSimpleEvent" /> for a description of the
+ *          event fields. The ActorId field is not used.
+ *
+ * @param           count   Number of events.
+ * @param [in]      events  Array with count events.
+ * @param [out]     errors  Array with count elements receiving the result of the operation for
+ *                          each event. Can be null if the per event results are not required.
+ *
+ * @return  A HRESULT code with the result of the operation. Returns S_OK if all events were
+ *          successfully processed, S_FALSE if at least one event could not be processed and
+ *          E_INVALIDARG if events is null.
+ */
+
+HRESULT ProcessSimpleEvents(int count, AeEventRecord* events, HRESULT* errors);
+
+/**
+ * @fn  HRESULT ProcessTrackingEvents(int count, AeEventRecord* events, HRESULT* errors);
+ *
+ * @brief   Generates several Tracking Events with one call.
+ *          
+ *          The events are processed in the order of the events array. See
+ *          <see cref="ProcessTrackingEvent" text="ProcessTrackingEvent" /> for a description of
+ *          the event fields.
+ *
+ * @param           count   Number of events.
+ * @param [in]      events  Array with count events.
+ * @param [out]     errors  Array with count elements receiving the result of the operation for
+ *                          each event. Can be null if the per event results are not required.
+ *
+ * @return  A HRESULT code with the result of the operation. Returns S_OK if all events were
+ *          successfully processed, S_FALSE if at least one event could not be processed and
+ *          E_INVALIDARG if events is null.
+ */
+
+HRESULT ProcessTrackingEvents(int count, AeEventRecord* events, HRESULT* errors);
+
 /**
  * @fn  HRESULT ProcessConditionStateChanges(int count, AeConditionState* conditionStateChanges);
  *
@@ -1656,6 +1881,70 @@ DLLEXP HRESULT DLLCALL OnAddItem(void* deviceItemHandle);
 
 DLLEXP HRESULT DLLCALL OnRemoveItem(void* deviceItemHandle);
 
+/**
+ * @fn  HRESULT DLLCALL OnAddItems(int count, void** deviceItemHandles);
+ *
+ * @brief   The device items were added to a group or get used for item based read/write.
+ *          
+ *          This method is called from a background thread of the customization plugin and not
+ *          from the generic server; it is not exported. It is only called if OnAddItem forwards
+ *          the notification with
+ *          <see cref="QueueAddItem@void*" text="QueueAddItem" />.
+ *          
+ *          RemoveItem discards the pending notifications of the removed item. A batch whose
+ *          delivery has already started can still contain the handle of an item removed in the
+ *          meantime. Check the handles against the items of the customization plugin before
+ *          using them.
+ *          
+ *          OnRemoveItems is called before OnAddItems for the same batch. The result is not
+ *          evaluated; the other function is still called if one fails and the notifications of
+ *          the failed call are not delivered again.
+ *
+ * @param           count               Number of device items.
+ * @param [in]      deviceItemHandles   Array with count Device Items that need to be updated.
+ *
+ * @return  A result code with the result of the operation.
+ */
+
+DLLEXP HRESULT DLLCALL OnAddItems(int count, void** deviceItemHandles);
+
+/**
+ * @fn  HRESULT DLLCALL OnRemoveItems(int count, void** deviceItemHandles);
+ *
+ * @brief   The device items are no longer used by clients.
+ *          
+ *          This method is called from a background thread of the customization plugin and not
+ *          from the generic server; it is not exported. It is only called if OnRemoveItem
+ *          forwards the notification with
+ *          <see cref="QueueRemoveItem@void*" text="QueueRemoveItem" />. See
+ *          <see cref="OnAddItems@int@void**" text="OnAddItems" /> for removed items and
+ *          failed calls.
+ *
+ * @param           count               Number of device items.
+ * @param [in]      deviceItemHandles   Array with count Device Items that no longer need to be
+ *                                      updated.
+ *
+ * @return  A result code with the result of the operation.
+ */
+
+DLLEXP HRESULT DLLCALL OnRemoveItems(int count, void** deviceItemHandles);
+
+/**
+ * @fn  int DLLCALL OnGetItemNotificationDelay();
+ *
+ * @brief   Returns the batch window in milliseconds for the notifications queued with
+ *          QueueAddItem and QueueRemoveItem. The window starts with the first notification
+ *          queued after the previous batch; all notifications queued until it ends are delivered
+ *          with one OnRemoveItems and one OnAddItems call.
+ *          
+ *          This method is called once, when the first notification is queued. It is not
+ *          exported.
+ *
+ * @return  The batch window in milliseconds.
+ */
+
+DLLEXP int DLLCALL OnGetItemNotificationDelay();
+
 /**
  * @fn  HRESULT DLLCALL OnAckNotification(int conditionId, int subConditionId);
  *
@@ -1736,6 +2025,7 @@ DLLEXP void DLLCALL OnGetLogPath(char * logPath);
  *          
  *          * add the items to the servers real address space and return
  *            S_OK. For each item to be added the callback method 'AddItem' has to be called.
+ *            If many items are requested, add them with one call of 'AddItems' instead.
  *          * return S_FALSE.
  *
  * @param   numItems            Number of defined item handles.
@@ -30,6 +30,7 @@
 #region Using Directives
 
 using System;
+using System.Collections.Generic;
 using System.Xml;
 using System.Threading;
 
@@ -1223,6 +1224,48 @@ namespace ServerPlugin
 
         }
     }
+
+    /// <summary>
+    /// A Simple or Tracking Event passed to ProcessSimpleEvents or ProcessTrackingEvents.
+    /// </summary>
+    public class AeEventRecord
+    {
+        #region Public Members
+        /// <summary>
+        /// Identifier of an existing Event Category.
+        /// </summary>
+        public int CategoryId;
+        /// <summary>
+        /// Identifier of an existing Event Source.
+        /// </summary>
+        public int SourceId;
+        /// <summary>
+        /// Message text string which describes the Event.
+        /// </summary>
+        public string Message;
+        /// <summary>
+        /// Event severity (1..1000).
+        /// </summary>
+        public int Severity;
+        /// <summary>
+        /// Text string which identifies the OPC Client which initiated the action. Only used for Tracking Events.
+        /// </summary>
+        public string ActorId;
+        /// <summary>
+        /// Number of attribute values specified in AttributeValues. This number must be identical with the number of
+        /// attributes added to the specified Event Category. It is only used for cross-check.
+        /// </summary>
+        public int AttributeCount;
+        /// <summary>
+        /// Attribute values
+        /// </summary>
+        public object[] AttributeValues;
+        /// <summary>
+        /// Occurrence time of the event.
+        /// </summary>
+        public DateTime TimeStamp;
+        #endregion
+    }
     #endregion
 
     #region Callback delegates - DON'T USE DIRECTLY.
@@ -1695,11 +1738,19 @@ namespace ServerPlugin
     {
         #region Fields
 
-        static private readonly Mutex mutexSetVal_ = new Mutex(false);
+        // Serializes the SetItemValue callbacks. A monitor is used instead of a kernel mutex
+        // because it is held only for the duration of the callback and is mostly uncontended.
+        static private readonly object setValLock_ = new object();
 
         static internal ClassicServerDefinition DaServer;
         static internal ClassicServerDefinition AeServer;
 
+        // Pending OnAddItem/OnRemoveItem notifications; +1 for each add and -1 for each remove
+        static private readonly object pendingItemsLock_ = new object();
+        static private Dictionary<IntPtr, int> pendingItems_ = new Dictionary<IntPtr, int>();
+        static private readonly AutoResetEvent pendingItemsEvent_ = new AutoResetEvent(false);
+        static private Thread itemNotificationThread_;
+
         #region Data Access Callback methods
 
         private static AddItem addItemCallback_;
@@ -1999,6 +2050,91 @@ namespace ServerPlugin
             return StatusCodes.BadNotImplemented;
         }
 
+        /// <summary>
+        /// 	<para>
+        ///         This function is called by the customization plugin and adds several items
+        ///         to the generic server cache with one call. It is intended for plugins which
+        ///         define a large number of items in OnCreateServerItems.
+        ///     </para>
+        /// 	<para>The items are added in the order of the itemIds array.</para>
+        /// </summary>
+        /// <returns>
+        ///     A <see cref="StatusCodes">StatusCodes</see> code with the result of the operation.
+        ///     Returns StatusCodes.Good if all items were successfully added to the cache and
+        ///     StatusCodes.Bad if at least one item could not be added.
+        /// </returns>
+        /// <param name="itemIds">Fully qualified item names.</param>
+        /// <param name="accessRights">Access rights of the items.</param>
+        /// <param name="initValues">Objects with the initial values and the items' canonical data types.</param>
+        /// <param name="euTypes">
+        /// Engineering unit types of the items. Can be null, in this case
+        /// <see cref="DaEuType">DaEuType.NoEnum</see> is used for all items.
+        /// </param>
+        /// <param name="minValues">
+        /// LOW EU ranges of the items. Only used for items with <see cref="DaEuType">DaEuType.Analog</see>;
+        /// required if at least one entry of euTypes is DaEuType.Analog, otherwise it can be null.
+        /// </param>
+        /// <param name="maxValues">
+        /// HIGH EU ranges of the items. Only used for items with <see cref="DaEuType">DaEuType.Analog</see>;
+        /// required if at least one entry of euTypes is DaEuType.Analog, otherwise it can be null.
+        /// </param>
+        /// <param name="deviceItemHandles">Handles returned by the generic server executable to reference the items.</param>
+        /// <param name="errors">The result of the operation for each item.</param>
+        public static int AddItems(string[] itemIds, DaAccessRights[] accessRights, object[] initValues, DaEuType[] euTypes, double[] minValues, double[] maxValues, out IntPtr[] deviceItemHandles, out int[] errors)
+        {
+            deviceItemHandles = null;
+            errors = null;
+            if (itemIds == null || accessRights == null || initValues == null)
+            {
+                return StatusCodes.BadInvalidArgument;
+            }
+            int count = itemIds.Length;
+            if (accessRights.Length < count || initValues.Length < count)
+            {
+                return StatusCodes.BadInvalidArgument;
+            }
+            if (euTypes != null)
+            {
+                if (euTypes.Length < count)
+                {
+                    return StatusCodes.BadInvalidArgument;
+                }
+                if (minValues == null || minValues.Length < count || maxValues == null || maxValues.Length < count)
+                {
+                    // EU ranges are only required for analog items
+                    for (int i = 0; i < count; i++)
+                    {
+                        if (euTypes[i] == DaEuType.Analog)
+                        {
+                            return StatusCodes.BadInvalidArgument;
+                        }
+                    }
+                }
+            }
+            if (addItemCallback_ == null)
+            {
+                return StatusCodes.BadNotImplemented;
+            }
+
+            int rtc = StatusCodes.Good;
+            deviceItemHandles = new IntPtr[count];
+            errors = new int[count];
+            for (int i = 0; i < count; i++)
+            {
+                DaEuType euType = euTypes != null ? euTypes[i] : DaEuType.NoEnum;
+                double minValue = euType == DaEuType.Analog ? minValues[i] : 0.0;
+                double maxValue = euType == DaEuType.Analog ? maxValues[i] : 0.0;
+
+                errors[i] = addItemCallback_(itemIds[i], accessRights[i], initValues[i], true, euType, minValue, maxValue, out deviceItemHandles[i]);
+                if (StatusCodes.Failed(errors[i]))
+                {
+                    deviceItemHandles[i] = IntPtr.Zero;
+                    rtc = StatusCodes.Bad;
+                }
+            }
+            return rtc;
+        }
+
         /// <summary>
         /// 	<para>
         ///         This function is called by the customization plugin and removes an item from
@@ -2015,6 +2151,11 @@ namespace ServerPlugin
         /// <returns>Returns StatusCodes.Good if the item was successfully removed from the cache.</returns>
         public static int RemoveItem(IntPtr deviceItemHandle)
         {
+            // the handle becomes invalid, don't pass it to OnAddItems/OnRemoveItems later
+            lock (pendingItemsLock_)
+            {
+                pendingItems_.Remove(deviceItemHandle);
+            }
             if (removeItemCallback_ != null)
             {
                 return removeItemCallback_(deviceItemHandle);
@@ -2076,20 +2217,131 @@ namespace ServerPlugin
         public static int SetItemValue(IntPtr deviceItemHandle, object newValue, short quality, DateTime timestamp)
         {
             int rtc;
-            mutexSetVal_.WaitOne();
-            try
+            lock (setValLock_)
             {
                 if (setItemValueCallback_ == null)
                 {
                     return StatusCodes.BadNotImplemented;
                 }
-                rtc = setItemValueCallback_(deviceItemHandle, newValue, quality, timestamp);
+                try
+                {
+                    rtc = setItemValueCallback_(deviceItemHandle, newValue, quality, timestamp);
+                }
+                catch
+                {
+                    rtc = StatusCodes.BadException;
+                }
+            }
+            return rtc;
+        }
+
+        /// <summary>
+        /// 	<para>Generic server callback method.</para>
+        /// 	<para>Write the values of several items into the cache with one call. Device
+        ///     drivers updating many items per scan should use this method instead of calling
+        ///     <see cref="SetItemValue">SetItemValue</see> for each item.</para>
+        /// </summary>
+        /// <returns>
+        /// 	<para>
+        ///         A <see cref="StatusCodes"/> code with the result of the operation.
+        ///     </para>
+        /// 	<para>Returns StatusCodes.Good if all values were successfully written into the
+        ///     cache and StatusCodes.Bad if at least one value could not be written.</para>
+        /// </returns>
+        /// <param name="deviceItemHandles">Item handles as returned in the AddItem method call.</param>
+        /// <param name="newValues">
+        /// 	<para>Objects with the new item values.</para>
+        /// 	<para>Each value must match the canonical data type of the corresponding item.<br/>
+        ///     null can be passed to change only the quality and timestamp of all items.</para>
+        /// </param>
+        /// <param name="qualities">New qualities of the item values.</param>
+        /// <param name="timestamps">New timestamps of the item values.</param>
+        /// <param name="errors">The result of the operation for each item.</param>
+        public static int SetItemValues(IntPtr[] deviceItemHandles, object[] newValues, short[] qualities, DateTime[] timestamps, out int[] errors)
+        {
+            errors = null;
+            return SetItemValues(deviceItemHandles, newValues, qualities, timestamps, ref errors, true);
+        }
+
+        /// <summary>
+        /// 	<para>Generic server callback method.</para>
+        /// 	<para>Write the values of several items into the cache with one call. Same as
+        ///     <see cref="SetItemValues(IntPtr[], object[], short[], DateTime[], out int[])">SetItemValues</see>,
+        ///     but the per item results are written into an array owned by the caller. Device drivers
+        ///     updating the same items every scan can reuse the array and avoid an allocation per call.</para>
+        /// </summary>
+        /// <returns>
+        /// 	<para>
+        ///         A <see cref="StatusCodes"/> code with the result of the operation.
+        ///     </para>
+        /// 	<para>Returns StatusCodes.Good if all values were successfully written into the
+        ///     cache and StatusCodes.Bad if at least one value could not be written.</para>
+        /// </returns>
+        /// <param name="deviceItemHandles">Item handles as returned in the AddItem method call.</param>
+        /// <param name="newValues">
+        /// 	<para>Objects with the new item values.</para>
+        /// 	<para>Each value must match the canonical data type of the corresponding item.<br/>
+        ///     null can be passed to change only the quality and timestamp of all items.</para>
+        /// </param>
+        /// <param name="qualities">New qualities of the item values.</param>
+        /// <param name="timestamps">New timestamps of the item values.</param>
+        /// <param name="errors">
+        /// Array receiving the result of the operation for each item; must have at least as many
+        /// elements as deviceItemHandles. Can be null if the per item results are not required.
+        /// </param>
+        public static int SetItemValues(IntPtr[] deviceItemHandles, object[] newValues, short[] qualities, DateTime[] timestamps, int[] errors)
+        {
+            return SetItemValues(deviceItemHandles, newValues, qualities, timestamps, ref errors, false);
+        }
+
+        private static int SetItemValues(IntPtr[] deviceItemHandles, object[] newValues, short[] qualities, DateTime[] timestamps, ref int[] errors, bool allocateErrors)
+        {
+            if (deviceItemHandles == null || qualities == null || timestamps == null)
+            {
+                return StatusCodes.BadInvalidArgument;
+            }
+            int count = deviceItemHandles.Length;
+            if (qualities.Length < count || timestamps.Length < count || (newValues != null && newValues.Length < count))
+            {
+                return StatusCodes.BadInvalidArgument;
             }
-            catch
+            if (!allocateErrors && errors != null && errors.Length < count)
+            {
+                return StatusCodes.BadInvalidArgument;
+            }
+
+            int rtc = StatusCodes.Good;
+            lock (setValLock_)
             {
-                rtc = StatusCodes.BadException;
+                if (setItemValueCallback_ == null)
+                {
+                    return StatusCodes.BadNotImplemented;
+                }
+                if (allocateErrors)
+                {
+                    errors = new int[count];
+                }
+                for (int i = 0; i < count; i++)
+                {
+                    int result;
+                    try
+                    {
+                        result = setItemValueCallback_(deviceItemHandles[i], newValues != null ? newValues[i] : null, qualities[i], timestamps[i]);
+                    }
+                    catch
+                    {
+                        result = StatusCodes.BadException;
+                    }
+                    if (errors != null)
+                    {
+                        errors[i] = result;
+                    }
+                    if (StatusCodes.Failed(result))
+                    {
+                        rtc = StatusCodes.Bad;
+                    }
+                }
             }
-            mutexSetVal_.ReleaseMutex();
             return rtc;
         }
 
@@ -2628,6 +2880,179 @@ namespace ServerPlugin
         {
             return StatusCodes.Good;
         }
+
+        /// <summary>
+        /// Batch window in milliseconds for the deferred OnAddItem/OnRemoveItem notifications. The window starts with the
+        /// first notification queued after the previous batch; all notifications queued until it ends are delivered with one
+        /// <see cref="OnAddItems">OnAddItems</see> and one <see cref="OnRemoveItems">OnRemoveItems</see> call.
+        /// The value is read once when the first notification is queued. The default is 100 ms.
+        /// </summary>
+        /// <remarks>
+        /// The pending notifications and the thread delivering them are shared by all instances of the class.
+        /// Only one node manager instance is supported, as created by the generic server.
+        /// </remarks>
+        protected virtual int ItemNotificationDelay
+        {
+            get { return 100; }
+        }
+
+        /// <summary>
+        ///  <para>The items referenced by deviceItemHandles were added to a group or get used for item based read/write.</para>
+        ///  <para>This method is called from a background thread of the customization plugin and not from the generic server.
+        ///     It is only called if <see cref="OnAddItem">OnAddItem</see> forwards the notification with
+        ///     <see cref="QueueAddItem">QueueAddItem</see>. Items which were added and removed again within
+        ///     the same batch window (<see cref="ItemNotificationDelay">ItemNotificationDelay</see>) are not reported.</para>
+        /// </summary>
+        /// <remarks>
+        /// <see cref="RemoveItem">RemoveItem</see> discards the pending notifications of the removed item. A batch whose delivery
+        /// has already started can still contain the handle of an item removed in the meantime. Check the handles against the items
+        /// of the customization plugin before using them, e.g. in <see cref="SetItemValue">SetItemValue</see>.
+        /// <para>OnRemoveItems is called before OnAddItems for the same batch. An exception thrown by either method is caught
+        /// and discarded without any further report; the other method is still called and the notifications of the failed
+        /// call are not delivered again.</para>
+        /// </remarks>
+        /// <param name="deviceItemHandles">Array of Generic Server device item handles</param>
+        /// <returns>A <see cref="StatusCodes" /> code with the result of the operation.</returns>
+        public virtual int OnAddItems(IntPtr[] deviceItemHandles)
+        {
+            return StatusCodes.Good;
+        }
+
+        /// <summary>
+        ///  <para>The items referenced by deviceItemHandles are no longer used by clients.</para>
+        ///  <para>This method is called from a background thread of the customization plugin and not from the generic server.
+        ///     It is only called if <see cref="OnRemoveItem">OnRemoveItem</see> forwards the notification with
+        ///     <see cref="QueueRemoveItem">QueueRemoveItem</see>. Items which were removed and added again within
+        ///     the same batch window (<see cref="ItemNotificationDelay">ItemNotificationDelay</see>) are not reported.</para>
+        /// </summary>
+        /// <remarks>
+        /// <see cref="RemoveItem">RemoveItem</see> discards the pending notifications of the removed item. A batch whose delivery
+        /// has already started can still contain the handle of an item removed in the meantime. Check the handles against the items
+        /// of the customization plugin before using them, e.g. in <see cref="SetItemValue">SetItemValue</see>.
+        /// <para>OnRemoveItems is called before OnAddItems for the same batch. An exception thrown by either method is caught
+        /// and discarded without any further report; the other method is still called and the notifications of the failed
+        /// call are not delivered again.</para>
+        /// </remarks>
+        /// <param name="deviceItemHandles">Array of Generic Server device item handles</param>
+        /// <returns>A <see cref="StatusCodes" /> code with the result of the operation.</returns>
+        public virtual int OnRemoveItems(IntPtr[] deviceItemHandles)
+        {
+            return StatusCodes.Good;
+        }
+
+        /// <summary>
+        /// Defers an OnAddItem notification. Call this method from an overload of
+        /// <see cref="OnAddItem">OnAddItem</see> to return immediately to the generic server and
+        /// receive the item later with <see cref="OnAddItems">OnAddItems</see>.
+        /// </summary>
+        /// <param name="deviceItemHandle">Generic Server device item handle</param>
+        /// <returns>Always returns StatusCodes.Good</returns>
+        protected int QueueAddItem(IntPtr deviceItemHandle)
+        {
+            QueueItemNotification(deviceItemHandle, 1);
+            return StatusCodes.Good;
+        }
+
+        /// <summary>
+        /// Defers an OnRemoveItem notification. Call this method from an overload of
+        /// <see cref="OnRemoveItem">OnRemoveItem</see> to return immediately to the generic server and
+        /// receive the item later with <see cref="OnRemoveItems">OnRemoveItems</see>.
+        /// </summary>
+        /// <param name="deviceItemHandle">Generic Server device item handle</param>
+        /// <returns>Always returns StatusCodes.Good</returns>
+        protected int QueueRemoveItem(IntPtr deviceItemHandle)
+        {
+            QueueItemNotification(deviceItemHandle, -1);
+            return StatusCodes.Good;
+        }
+
+        // The pending notifications are static like the callbacks of the generic server, which creates only one
+        // node manager instance. The notification thread is bound to the instance that queues the first notification.
+        private void QueueItemNotification(IntPtr deviceItemHandle, int delta)
+        {
+            Thread thread = null;
+            lock (pendingItemsLock_)
+            {
+                int count;
+                pendingItems_.TryGetValue(deviceItemHandle, out count);
+                count += delta;
+                if (count == 0)
+                {
+                    pendingItems_.Remove(deviceItemHandle);     // add/remove pair, nothing to report
+                }
+                else
+                {
+                    pendingItems_[deviceItemHandle] = count;
+                }
+
+                if (itemNotificationThread_ == null)
+                {
+                    thread = itemNotificationThread_ = new Thread(ItemNotificationThread) { IsBackground = true, Name = "ItemNotificationThread" };
+                }
+            }
+            pendingItemsEvent_.Set();
+            if (thread != null)
+            {
+                thread.Start(ItemNotificationDelay);       // don't call the overridable property while holding the lock
+            }
+        }
+
+        // Delivers the collected OnAddItem/OnRemoveItem notifications as batches.
+        private void ItemNotificationThread(object batchWindow)
+        {
+            var delay = (int)batchWindow;
+            var added = new List<IntPtr>();
+            var removed = new List<IntPtr>();
+
+            for (;;)
+            {
+                pendingItemsEvent_.WaitOne();
+                Thread.Sleep(delay);                        // collect further notifications of this batch
+
+                Dictionary<IntPtr, int> items;
+                lock (pendingItemsLock_)
+                {
+                    items = pendingItems_;
+                    pendingItems_ = new Dictionary<IntPtr, int>();
+                }
+
+                added.Clear();
+                removed.Clear();
+                foreach (KeyValuePair<IntPtr, int> item in items)
+                {
+                    if (item.Value > 0)
+                    {
+                        added.Add(item.Key);
+                    }
+                    else
+                    {
+                        removed.Add(item.Key);
+                    }
+                }
+
+                // errors of the customization plugin must not terminate this thread or drop the other batch
+                if (removed.Count > 0)
+                {
+                    try
+                    {
+                        OnRemoveItems(removed.ToArray());
+                    }
+                    catch
+                    {
+                    }
+                }
+                if (added.Count > 0)
+                {
+                    try
+                    {
+                        OnAddItems(added.ToArray());
+                    }
+                    catch
+                    {
+                    }
+                }
+            }
+        }
         #endregion
 
         #region  .NET API Dynamic Address Space handling Methods
@@ -2646,7 +3071,8 @@ namespace ServerPlugin
         /// 	<list type="bullet">
         /// 		<item>add the item to the servers real address space and return
         ///         StatusCodes.Good. For each item to be added the callback method 'AddItem' has
-        ///         to be called.</item>
+        ///         to be called. If many items are added, add them with one call of
+        ///         <see cref="AddItems">AddItems</see> instead.</item>
         /// 		<item>return StatusCodes.Bad</item>
         /// 	</list>
         /// </summary>
@@ -3242,6 +3668,92 @@ namespace ServerPlugin
             return StatusCodes.BadNotImplemented;
         }
 
+        /// <summary>Generates several Simple Events with one call.</summary>
+        /// <param name="events">The events to generate. The ActorId field is not used. Null entries are reported with StatusCodes.BadInvalidArgument.</param>
+        /// <param name="errors">The result of the operation for each event.</param>
+        /// <returns>
+        ///     A <see cref="StatusCodes">StatusCodes</see> code with the result of the operation.
+        ///     Returns StatusCodes.Good if all events were successfully processed and StatusCodes.Bad if at least one event could not be processed.
+        /// </returns>
+        /// <remarks>
+        /// The events are processed in the order of the events array. See <see cref="ProcessSimpleEvent">ProcessSimpleEvent</see> for a description
+        /// of the event fields.
+        /// </remarks>
+        public static int ProcessSimpleEvents(AeEventRecord[] events, out int[] errors)
+        {
+            errors = null;
+            if (events == null)
+            {
+                return StatusCodes.BadInvalidArgument;
+            }
+            if (processSimpleEvent_ == null)
+            {
+                return StatusCodes.BadNotImplemented;
+            }
+
+            int rtc = StatusCodes.Good;
+            errors = new int[events.Length];
+            for (int i = 0; i < events.Length; i++)
+            {
+                AeEventRecord e = events[i];
+                if (e == null)
+                {
+                    errors[i] = StatusCodes.BadInvalidArgument;
+                    rtc = StatusCodes.Bad;
+                    continue;
+                }
+                errors[i] = processSimpleEvent_(e.CategoryId, e.SourceId, e.Message, e.Severity, e.AttributeCount, e.AttributeValues, e.TimeStamp);
+                if (StatusCodes.Failed(errors[i]))
+                {
+                    rtc = StatusCodes.Bad;
+                }
+            }
+            return rtc;
+        }
+
+        /// <summary>Generates several Tracking Events with one call.</summary>
+        /// <param name="events">The events to generate. Null entries are reported with StatusCodes.BadInvalidArgument.</param>
+        /// <param name="errors">The result of the operation for each event.</param>
+        /// <returns>
+        ///     A <see cref="StatusCodes">StatusCodes</see> code with the result of the operation.
+        ///     Returns StatusCodes.Good if all events were successfully processed and StatusCodes.Bad if at least one event could not be processed.
+        /// </returns>
+        /// <remarks>
+        /// The events are processed in the order of the events array. See <see cref="ProcessTrackingEvent">ProcessTrackingEvent</see> for a description
+        /// of the event fields.
+        /// </remarks>
+        public static int ProcessTrackingEvents(AeEventRecord[] events, out int[] errors)
+        {
+            errors = null;
+            if (events == null)
+            {
+                return StatusCodes.BadInvalidArgument;
+            }
+            if (processTrackingEvent_ == null)
+            {
+                return StatusCodes.BadNotImplemented;
+            }
+
+            int rtc = StatusCodes.Good;
+            errors = new int[events.Length];
+            for (int i = 0; i < events.Length; i++)
+            {
+                AeEventRecord e = events[i];
+                if (e == null)
+                {
+                    errors[i] = StatusCodes.BadInvalidArgument;
+                    rtc = StatusCodes.Bad;
+                    continue;
+                }
+                errors[i] = processTrackingEvent_(e.CategoryId, e.SourceId, e.Message, e.Severity, e.ActorId, e.AttributeCount, e.AttributeValues, e.TimeStamp);
+                if (StatusCodes.Failed(errors[i]))
+                {
+                    rtc = StatusCodes.Bad;
+                }
+            }
+            return rtc;
+        }
+
         /// <summary>Changes the state of one or more Event Conditions.</summary>
         /// <param name="count">Number of Conditions to be changed.</param>
         /// <param name="conditionStateChanges">Array of class ConditionChangeStates with the new condition states.</param>
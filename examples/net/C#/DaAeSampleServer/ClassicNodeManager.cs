@@ -875,17 +875,37 @@ namespace ServerPlugin
                 items_.Add(myItem.DeviceItemHandle, myItem);
             }
 
-            // MassItems/Random
+            // MassItems/Random; all items are added with one call
             {
+                const int itemValue = 0; // canonical data type
+
+                var itemIds = new string[NumberMassItems];
+                var accessRights = new DaAccessRights[NumberMassItems];
+                var initValues = new object[NumberMassItems];
+                object initValue = itemValue;
                 for (int ii = 0; ii < NumberMassItems; ii++)
                 {
-                    const int itemValue = 0; // canonical data type
+                    itemIds[ii] = "MassItems.Random_" + ii.ToString("D4");
+                    accessRights[ii] = DaAccessRights.Readable;
+                    initValues[ii] = initValue;
+                }
 
-                    var itemId = "MassItems.Random_" + ii.ToString("D4");
-                    myItem = new MyItem(itemId, itemValue);
-                    AddItem(myItem.ItemName, DaAccessRights.Readable, itemValue, out myItem.DeviceItemHandle);
-                    items_.Add(myItem.DeviceItemHandle, myItem);
-                    dynamicItems_.Add(myItem.DeviceItemHandle, myItem);
+                IntPtr[] deviceItemHandles;
+                int[] errors;
+                AddItems(itemIds, accessRights, initValues, null, null, null, out deviceItemHandles, out errors);
+                if (errors != null)
+                {
+                    for (int ii = 0; ii < NumberMassItems; ii++)
+                    {
+                        if (StatusCodes.Failed(errors[ii]))
+                        {
+                            continue;
+                        }
+                        myItem = new MyItem(itemIds[ii], itemValue);
+                        myItem.DeviceItemHandle = deviceItemHandles[ii];
+                        items_.Add(myItem.DeviceItemHandle, myItem);
+                        dynamicItems_.Add(myItem.DeviceItemHandle, myItem);
+                    }
                 }
             }
         }
@@ -1024,6 +1044,20 @@ namespace ServerPlugin
                 SetItemValue(item.DeviceItemHandle, item.Value, DaQuality.Good.Code, DateTime.Now);
             }
 
+            // The buffers for the mass item update are allocated once and reused for every cycle
+            var massItems = new MyItem[dynamicItems_.Count];
+            dynamicItems_.Values.CopyTo(massItems, 0);
+            var massHandles = new IntPtr[massItems.Length];
+            var massValues = new object[massItems.Length];
+            var massQualities = new short[massItems.Length];
+            var massTimestamps = new DateTime[massItems.Length];
+            var massErrors = new int[massItems.Length];
+            for (int i = 0; i < massItems.Length; i++)
+            {
+                massHandles[i] = massItems[i].DeviceItemHandle;
+                massQualities[i] = DaQuality.Good.Code;
+            }
+
             for (; ; )   // forever thread loop
             {
                 //int numclientHandles;
@@ -1095,12 +1129,16 @@ namespace ServerPlugin
                    DaQuality.Good.Code, DateTime.Now);
 
                 DateTime dateTimeStart = DateTime.UtcNow;
-                // Update all used items once
-                foreach (MyItem item in dynamicItems_.Values)
+                // Update all mass items with one call; all items share the same boxed value
+                object rampValue = ramp;
+                DateTime now = DateTime.Now;
+                for (int i = 0; i < massItems.Length; i++)
                 {
-                    item.Value = ramp;
-                    SetItemValue(item.DeviceItemHandle, item.Value, DaQuality.Good.Code, DateTime.Now);
+                    massItems[i].Value = rampValue;
+                    massValues[i] = rampValue;
+                    massTimestamps[i] = now;
                 }
+                SetItemValues(massHandles, massValues, massQualities, massTimestamps, massErrors);
                 TimeSpan duration = (DateTime.UtcNow - dateTimeStart);
 
                 double callsPerSecond = 1 / (duration.TotalSeconds / NumberMassItems);